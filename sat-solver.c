@@ -4,8 +4,35 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <time.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <stdatomic.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 int track = 0;
+int useCache = 0; // 0 = off, 1 = exact clause set, 2 = clause set up to variable renaming
+int useSymmetry = 0; // Add symmetry-breaking clauses before resolution, DP and DPLL
+
+// Per-solve resource budgets, 0 = unlimited
+typedef struct {
+    long timeMs;      // Wall-clock time
+    long decisions;   // Branching decisions (DPLL, DP, enumeration, counting)
+    long conflicts;   // Falsified clauses reached
+    long resolvents;  // Resolvents generated (resolution)
+    long bytes;       // Bytes allocated for derived clauses
+} Budget;
+
+Budget budget = {0, 0, 0, 0, 0};
 
 // Clears the terminal screen, depending on the operating system
 void clearTerminal() {
@@ -95,6 +122,19 @@ void showOpts() {
     if(track == 0) printf(" (off)\n");
     else printf(" (on)\n");
     printf("7. Exit\n");
+    printf("8. Enumerate models\n");
+    printf("9. Count models (#SAT)\n");
+    printf("10. Result cache");
+    if(useCache == 0) printf(" (off)\n");
+    else if(useCache == 1) printf(" (on)\n");
+    else printf(" (on, up to variable renaming)\n");
+    printf("11. Resolution (parallel)\n");
+    printf("12. Budgets");
+    if(budget.timeMs || budget.decisions || budget.conflicts || budget.resolvents || budget.bytes) printf(" (set)\n");
+    else printf(" (none)\n");
+    printf("13. Symmetry breaking");
+    if(useSymmetry == 0) printf(" (off)\n");
+    else printf(" (on)\n");
 }
 
 // Negates a literal (a <-> A, B <-> b, etc.)
@@ -142,13 +182,201 @@ int isNewClause(char **resolvents, int count, char *clause) {
     return 1;
 }
 
+// === Resource budgets ===
+// Engines charge each decision, conflict, resolvent and allocation before acting on it; a charge that
+// would go past its budget is refused, so the reported usage never exceeds a budget
+// budgetExceeded() is polled in the inner loops for the time budget and for a budget already used up
+// Once a budget runs out the engine stops, prints its partial statistics and reports UNKNOWN
+
+#define SAT_UNKNOWN -1
+
+// Resources used by the solve in progress
+typedef struct {
+    double startMs;
+    long decisions, conflicts, resolvents, bytes;
+    int checks;             // Calls since the clock was last read
+    const char *exhausted;  // Name of the budget that ran out, NULL while within budget
+} BudgetUsage;
+
+BudgetUsage usage;
+
+// Current wall-clock time in milliseconds
+double wallClockMs() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Resets the usage counters at the start of a solve
+void budgetStart() {
+    memset(&usage, 0, sizeof(usage));
+    usage.startMs = wallClockMs();
+}
+
+// Returns 1 once the time budget has run out
+// Only reads shared state, so worker threads may call it
+int budgetTimeUp() {
+    return budget.timeMs > 0 && wallClockMs() - usage.startMs >= budget.timeMs;
+}
+
+// Returns 1 if any budget has run out
+// The clock is only read every 256 calls to keep this cheap
+int budgetExceeded() {
+    if (usage.exhausted != NULL) return 1;
+
+    if (budget.timeMs > 0 && ++usage.checks >= 256) {
+        usage.checks = 0;
+        if (budgetTimeUp()) usage.exhausted = "time";
+    }
+    return usage.exhausted != NULL;
+}
+
+// Adds amount to a usage counter if that stays within its limit (0 = unlimited)
+// Returns 0 without counting, and marks the budget as exhausted, if it would not
+int budgetCharge(long *used, long limit, long amount, const char *name) {
+    if (usage.exhausted != NULL) return 0;
+    if (limit > 0 && *used + amount > limit) {
+        usage.exhausted = name;
+        return 0;
+    }
+    *used += amount;
+    return 1;
+}
+
+int budgetDecision() {
+    return budgetCharge(&usage.decisions, budget.decisions, 1, "decisions");
+}
+
+int budgetConflict() {
+    return budgetCharge(&usage.conflicts, budget.conflicts, 1, "conflicts");
+}
+
+int budgetBytes(long bytes) {
+    return budgetCharge(&usage.bytes, budget.bytes, bytes, "memory");
+}
+
+// Charges one resolvent of the given size, counting neither if either budget would be exceeded
+int budgetResolvent(long bytes) {
+    if (usage.exhausted != NULL) return 0;
+    if (budget.resolvents > 0 && usage.resolvents >= budget.resolvents) usage.exhausted = "resolvents";
+    else if (budget.bytes > 0 && usage.bytes + bytes > budget.bytes) usage.exhausted = "memory";
+    if (usage.exhausted != NULL) return 0;
+    usage.resolvents++;
+    usage.bytes += bytes;
+    return 1;
+}
+
+// Prints why the solve stopped and what it used so far
+void budgetReport() {
+    printf("Budget exhausted (%s). The result is UNKNOWN.\n", usage.exhausted);
+    printf("Used: %.2f ms, %ld decision(s), %ld conflict(s), %ld resolvent(s), %ld byte(s)\n",
+           wallClockMs() - usage.startMs, usage.decisions, usage.conflicts, usage.resolvents, usage.bytes);
+}
+
+// Reads the budgets from the user, 0 meaning unlimited
+void readBudget() {
+    long *fields[] = {&budget.timeMs, &budget.decisions, &budget.conflicts, &budget.resolvents, &budget.bytes};
+    const char *names[] = {"Time (ms)", "Decisions", "Conflicts", "Resolvents", "Memory (bytes)"};
+
+    printf("Enter the budgets (0 = unlimited):\n");
+    for (int i = 0; i < 5; i++) {
+        while (1) {
+            printf("  %s: ", names[i]);
+            if (scanf("%ld", fields[i]) == 1 && *fields[i] >= 0) break;
+            printf("  Invalid input. Must be >= 0.\n");
+            while ((getchar()) != '\n'); // Clear input buffer
+        }
+        while ((getchar()) != '\n'); // Clear newline
+    }
+
+    clearTerminal();
+    printf("Budgets set!\n\n");
+}
+
+// === Occurrence lists ===
+// For every literal, the ids of the clauses that contain it, in increasing order
+// Engines keep the index up to date as clauses are added, removed or strengthened,
+// so "clauses containing lit" is a list walk instead of a scan over every clause
+
+// One list per literal
+typedef struct {
+    int *ids;
+    int count, capacity;
+} OccList;
+
+typedef struct {
+    OccList lists[52]; // a-z, then A-Z
+} OccIndex;
+
+// Maps a literal to its list (a -> 0, ..., z -> 25, A -> 26, ..., Z -> 51)
+int litIndex(char lit) {
+    return islower(lit) ? lit - 'a' : 26 + lit - 'A';
+}
+
+// Maps a list index back to its literal
+char indexLit(int index) {
+    return index < 26 ? 'a' + index : 'A' + index - 26;
+}
+
+// Returns the clauses containing lit
+OccList *occurrences(OccIndex *occ, char lit) {
+    return &occ->lists[litIndex(lit)];
+}
+
+void occInit(OccIndex *occ) {
+    memset(occ, 0, sizeof(OccIndex));
+}
+
+void occFree(OccIndex *occ) {
+    for (int i = 0; i < 52; i++) free(occ->lists[i].ids);
+    occInit(occ);
+}
+
+// Registers a new clause; ids must be added in increasing order to keep the lists sorted
+void occAddClause(OccIndex *occ, int id, const char *clause) {
+    for (int i = 0; clause[i] != '\0'; i++) {
+        OccList *list = occurrences(occ, clause[i]);
+        if (list->count > 0 && list->ids[list->count - 1] == id) continue; // Repeated literal
+        if (list->count == list->capacity) {
+            list->capacity = list->capacity ? list->capacity * 2 : 8;
+            list->ids = realloc(list->ids, list->capacity * sizeof(int));
+        }
+        list->ids[list->count++] = id;
+    }
+}
+
+// Drops one literal of a clause from the index (clause strengthened)
+void occRemoveLiteral(OccIndex *occ, int id, char lit) {
+    OccList *list = occurrences(occ, lit);
+    int lo = 0, hi = list->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (list->ids[mid] == id) {
+            memmove(list->ids + mid, list->ids + mid + 1, (list->count - mid - 1) * sizeof(int));
+            list->count--;
+            return;
+        }
+        if (list->ids[mid] < id) lo = mid + 1;
+        else hi = mid - 1;
+    }
+}
+
+// Drops a whole clause from the index (clause removed)
+void occRemoveClause(OccIndex *occ, int id, const char *clause) {
+    for (int i = 0; clause[i] != '\0'; i++) occRemoveLiteral(occ, id, clause[i]);
+}
+
 // Implements the resolution algorithm to try to derive an empty clause
 void resolution(int C, char **clauses) {
     char **allClauses = (char **)malloc(1000 * sizeof(char *)); // Arbitrary large space for clauses
     int total = 0;
+    OccIndex occ;
+    occInit(&occ);
+    budgetStart();
 
     // Copy initial clauses to allClauses
     for (int i = 0; i < C; i++) {
+        occAddClause(&occ, total, clauses[i]);
         allClauses[total++] = strdup(clauses[i]);
     }
 
@@ -157,42 +385,56 @@ void resolution(int C, char **clauses) {
     while (newDerived) {
         newDerived = 0;
 
-        // Iterate through all pairs of clauses
+        // Iterate through all pairs of clauses that clash on a literal
         for (int i = 0; i < total; i++) {
-            for (int j = i + 1; j < total; j++) {
-                for (int k = 0; allClauses[i][k] != '\0'; k++) {
-                    char lit = allClauses[i][k];
-                    char neg = negate(lit);
-
-                    // Check if the negation of the literal exists in the other clause
-                    // If it does, resolve the clauses
-                    if (clauseContains(allClauses[j], neg)) {
-                        char *res = resolveClauses(allClauses[i], allClauses[j], lit);
-
-                        // Check if the resolvent is empty
-                        // If it is, the formula is unsatisfiable
-                        // and we can exit the loop
-                        if (strlen(res) == 0) {
-                            printf("Derived empty clause from [%s] and [%s].\n", allClauses[i], allClauses[j]);
-                            printf("The formula is UNSAT.\n");
-                            free(res);
-                            for (int x = 0; x < total; x++) free(allClauses[x]);
-                            free(allClauses);
-                            return;
-                        }
-
-                        // Check if the resolvent is new
-                        // If it is, add it to the list of all clauses
-                        // and set newDerived to 1
-                        // to continue the loop
-                        // Otherwise, free the resolvent
-                        if (isNewClause(allClauses, total, res)) {
-                            printf("New clause from [%s] and [%s]: %s\n", allClauses[i], allClauses[j], res);
-                            allClauses[total++] = res;
-                            newDerived = 1;
-                        } else {
-                            free(res);
-                        }
+            for (int k = 0; allClauses[i][k] != '\0'; k++) {
+                char lit = allClauses[i][k];
+                char neg = negate(lit);
+
+                // Only the clauses containing the negation of the literal can be resolved with clause i
+                // The list grows while we walk it, as in the original all-pairs loop
+                OccList *clashing = occurrences(&occ, neg);
+                for (int x = 0; x < clashing->count; x++) {
+                    int j = clashing->ids[x];
+                    if (j <= i) continue;
+
+                    char *res = resolveClauses(allClauses[i], allClauses[j], lit);
+
+                    // Stop with UNKNOWN once a budget runs out; a resolvent past the budget is dropped uncounted
+                    if (budgetExceeded() || !budgetResolvent(strlen(res) + 1)) {
+                        budgetReport();
+                        free(res);
+                        for (int y = 0; y < total; y++) free(allClauses[y]);
+                        free(allClauses);
+                        occFree(&occ);
+                        return;
+                    }
+
+                    // Check if the resolvent is empty
+                    // If it is, the formula is unsatisfiable
+                    // and we can exit the loop
+                    if (strlen(res) == 0) {
+                        printf("Derived empty clause from [%s] and [%s].\n", allClauses[i], allClauses[j]);
+                        printf("The formula is UNSAT.\n");
+                        free(res);
+                        for (int y = 0; y < total; y++) free(allClauses[y]);
+                        free(allClauses);
+                        occFree(&occ);
+                        return;
+                    }
+
+                    // Check if the resolvent is new
+                    // If it is, add it to the list of all clauses
+                    // and set newDerived to 1
+                    // to continue the loop
+                    // Otherwise, free the resolvent
+                    if (isNewClause(allClauses, total, res)) {
+                        printf("New clause from [%s] and [%s]: %s\n", allClauses[i], allClauses[j], res);
+                        occAddClause(&occ, total, res);
+                        allClauses[total++] = res;
+                        newDerived = 1;
+                    } else {
+                        free(res);
                     }
                 }
             }
@@ -203,6 +445,7 @@ void resolution(int C, char **clauses) {
 
     for (int i = 0; i < total; i++) free(allClauses[i]);
     free(allClauses);
+    occFree(&occ);
 
     printf("Press Enter to continue...\n");
     getchar();
@@ -238,10 +481,104 @@ int is_satisfied(char **clauses, int num_clauses, int *assignments, int num_vars
     return 1;
 }
 
+// Returns the variable index of a literal (a/A -> 0, b/B -> 1, ...)
+int varOf(char lit) {
+    return tolower(lit) - 'a';
+}
+
+// Builds a bitmask of the variables used in a clause (bit i <-> letter 'a' + i)
+int clauseMask(const char *clause) {
+    int mask = 0;
+    for (int i = 0; clause[i] != '\0'; i++) {
+        mask |= 1 << varOf(clause[i]);
+    }
+    return mask;
+}
+
+// Counts the number of set bits in a variable mask
+int countBits(int mask) {
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+// djb2 string hash
+unsigned long hashString(const char *s) {
+    unsigned long h = 5381;
+    while (*s) h = h * 33 + (unsigned char)*s++;
+    return h;
+}
+
+int compareChars(const void *a, const void *b) {
+    return *(const char *)a - *(const char *)b;
+}
+
+int compareStrings(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Builds the canonical form of a set of clauses: literals sorted and deduplicated inside each clause,
+// clauses sorted and deduplicated, joined with ','
+// Two clause sets that differ only in clause order, literal order or duplicates get the same key
+char *canonicalKey(char **clauses, int C) {
+    char **sorted = malloc((C > 0 ? C : 1) * sizeof(char *));
+    int length = 1;
+    for (int i = 0; i < C; i++) {
+        int len = strlen(clauses[i]);
+        char *clause = malloc(len + 1);
+        memcpy(clause, clauses[i], len + 1);
+        qsort(clause, len, 1, compareChars);
+        int k = 0;
+        for (int j = 0; j < len; j++) {
+            if (k == 0 || clause[k - 1] != clause[j]) clause[k++] = clause[j];
+        }
+        clause[k] = '\0';
+        sorted[i] = clause;
+        length += k + 1;
+    }
+    qsort(sorted, C, sizeof(char *), compareStrings);
+
+    char *key = malloc(length);
+    int pos = 0;
+    for (int i = 0; i < C; i++) {
+        if (i > 0 && strcmp(sorted[i], sorted[i - 1]) == 0) continue;
+        int len = strlen(sorted[i]);
+        memcpy(key + pos, sorted[i], len);
+        pos += len;
+        key[pos++] = ',';
+    }
+    key[pos] = '\0';
+
+    for (int i = 0; i < C; i++) free(sorted[i]);
+    free(sorted);
+    return key;
+}
+
+// Evaluates a clause under a partial assignment
+// Returns 1 if satisfied, -1 if every literal is false, 0 if it is still open
+int clauseStatus(const char *clause, int *assignments) {
+    int open = 0;
+    for (int i = 0; clause[i] != '\0'; i++) {
+        int var = varOf(clause[i]);
+        if (assignments[var] == 0) {
+            open = 1;
+        } else if ((islower(clause[i]) && assignments[var] == 1) ||
+                   (isupper(clause[i]) && assignments[var] == -1)) {
+            return 1;
+        }
+    }
+    return open ? 0 : -1;
+}
+
 // DPLL algorithm for SAT solving
 // It recursively assigns values to variables and checks for satisfiability
-// Returns 1 if satisfiable, 0 otherwise
+// Returns 1 if satisfiable, 0 otherwise, SAT_UNKNOWN if a budget ran out
 int dpll(char **clauses, int num_clauses, int *assignments, int num_vars) {
+    if (budgetExceeded()) return SAT_UNKNOWN;
+
     // Check if all clauses are satisfied or if there are no clauses left
     // If all clauses are satisfied, return SAT
     if (is_satisfied(clauses, num_clauses, assignments, num_vars)) {
@@ -251,34 +588,766 @@ int dpll(char **clauses, int num_clauses, int *assignments, int num_vars) {
         return 1; // No clauses left to satisfy, SAT
     }
 
+    // Backtrack as soon as some clause has all of its literals assigned false
+    for (int i = 0; i < num_clauses; i++) {
+        if (clauseStatus(clauses[i], assignments) == -1) {
+            if (!budgetConflict()) return SAT_UNKNOWN;
+            return 0; // Conflict
+        }
+    }
+
     // Unit propagation
+    // Only unit clauses on unassigned variables propagate, one contradicting the assignment is a conflict
     for (int i = 0; i < num_clauses; i++) {
         if (strlen(clauses[i]) == 1) { // Unit clause
             char literal = clauses[i][0];
             int var = tolower(literal) - 'a';
-            assignments[var] = (literal == tolower(literal)) ? 1 : -1;
-            return dpll(clauses, num_clauses, assignments, num_vars);
+            int val = (literal == tolower(literal)) ? 1 : -1;
+            if (assignments[var] == val) continue; // Already satisfied
+            if (assignments[var] != 0) {
+                if (!budgetConflict()) return SAT_UNKNOWN;
+                return 0; // Conflict
+            }
+            assignments[var] = val;
+            int result = dpll(clauses, num_clauses, assignments, num_vars);
+            if (result == 0) assignments[var] = 0; // Backtrack
+            return result;
         }
     }
 
     // Choosing a literal and trying both true and false
     for (int i = 0; i < num_vars; i++) {
         if (assignments[i] == 0) { // If unassigned
+            if (!budgetDecision()) return SAT_UNKNOWN;
             assignments[i] = 1;
-            if (dpll(clauses, num_clauses, assignments, num_vars)) {
-                return 1; // SAT
+            int result = dpll(clauses, num_clauses, assignments, num_vars);
+            if (result != 0) {
+                return result; // SAT or UNKNOWN
             }
             assignments[i] = -1;
-            if (dpll(clauses, num_clauses, assignments, num_vars)) {
-                return 1; // SAT
+            result = dpll(clauses, num_clauses, assignments, num_vars);
+            if (result != 0) {
+                return result; // SAT or UNKNOWN
             }
             assignments[i] = 0; // Backtrack
             return 0; // UNSAT
         }
     }
+    if (!budgetConflict()) return SAT_UNKNOWN;
     return 0; // UNSAT
 }
 
+// === Persistent result cache ===
+// Results are stored in a fixed-size open-addressing table inside CACHE_FILE, which stays memory-mapped
+// while the program runs, so a lookup is just a probe into the mapping (no load step)
+// Keys are 64-bit hashes of the canonical clause set, optionally after a canonical renaming of the variables
+// A second hash and the key length are stored too, so an UNSAT hit (which cannot be re-checked) is not
+// trusted on one hash alone
+// A key is only looked for in its first CACHE_PROBES slots; when they are all taken the home slot is
+// overwritten, so a full table keeps caching and simply forgets older results
+// Several processes may share the file: lookups hold a shared lock on it and stores an exclusive one,
+// so a record is never read while another process is half-way through writing it
+
+#define CACHE_FILE "sat-cache.bin"
+#define CACHE_MAGIC "SATCACHE"
+#define CACHE_VERSION 2
+#define CACHE_SLOTS 4096
+#define CACHE_PROBES 16
+
+#define CACHE_EMPTY 0
+#define CACHE_SAT 1
+#define CACHE_UNSAT 2
+
+// Start of the cache file; a file whose header does not match is rebuilt as an empty table
+typedef struct {
+    char magic[8];            // CACHE_MAGIC
+    uint32_t version;         // CACHE_VERSION
+    uint32_t recordSize;      // sizeof(CacheRecord)
+    uint32_t slots;           // CACHE_SLOTS
+    uint32_t padding;
+} CacheHeader;
+
+typedef struct {
+    uint64_t key;
+    uint64_t check;           // Second, independently seeded hash of the canonical clause set
+    int32_t status;           // CACHE_EMPTY, CACHE_SAT or CACHE_UNSAT
+    uint32_t keyLength;       // Length of the canonical clause set
+    signed char model[26];    // Model in canonical variable labels (1 true, -1 false, 0 unassigned)
+    char padding[6];
+} CacheRecord;
+
+CacheHeader *cacheHeader = NULL; // Start of the mapping
+CacheRecord *resultCache = NULL; // Slots, right after the header
+#ifdef _WIN32
+    HANDLE cacheFileHandle = INVALID_HANDLE_VALUE;
+    HANDLE cacheMapHandle = NULL;
+#else
+    int cacheFd = -1;         // Kept open for the file lock
+#endif
+
+// FNV-1a 64-bit string hash, starting from the given offset basis
+uint64_t hashString64(const char *s, uint64_t seed) {
+    uint64_t h = seed;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Takes the cache file lock, shared for reading slots and exclusive for writing them
+void lockResultCache(int exclusive) {
+    #ifdef _WIN32
+        OVERLAPPED overlapped = {0};
+        LockFileEx(cacheFileHandle, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, 1, 0, &overlapped);
+    #else
+        while (flock(cacheFd, exclusive ? LOCK_EX : LOCK_SH) != 0 && errno == EINTR);
+    #endif
+}
+
+// Releases the cache file lock
+void unlockResultCache() {
+    #ifdef _WIN32
+        OVERLAPPED overlapped = {0};
+        UnlockFileEx(cacheFileHandle, 0, 1, 0, &overlapped);
+    #else
+        flock(cacheFd, LOCK_UN);
+    #endif
+}
+
+// Size of the whole cache file
+size_t cacheFileSize() {
+    return sizeof(CacheHeader) + CACHE_SLOTS * sizeof(CacheRecord);
+}
+
+// Maps the cache file into memory, creating it on first use
+// A missing, resized, foreign or older-version file is reset to an empty table
+// Returns 1 on success, 0 if the cache is unavailable
+int openResultCache() {
+    if (resultCache != NULL) return 1;
+    size_t size = cacheFileSize();
+    void *map;
+
+    #ifdef _WIN32
+        // Other processes may use the cache at the same time
+        cacheFileHandle = CreateFileA(CACHE_FILE, GENERIC_READ | GENERIC_WRITE,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                      OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (cacheFileHandle == INVALID_HANDLE_VALUE) return 0;
+        lockResultCache(1); // Another process may be creating or resetting the file right now
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(cacheFileHandle, &fileSize) || fileSize.QuadPart != (LONGLONG)size) {
+            // Wrong size: truncate, the mapping below grows it back zero-filled
+            SetFilePointer(cacheFileHandle, 0, NULL, FILE_BEGIN);
+            SetEndOfFile(cacheFileHandle);
+        }
+        cacheMapHandle = CreateFileMappingA(cacheFileHandle, NULL, PAGE_READWRITE, 0, (DWORD)size, NULL);
+        if (cacheMapHandle == NULL) {
+            unlockResultCache();
+            CloseHandle(cacheFileHandle);
+            cacheFileHandle = INVALID_HANDLE_VALUE;
+            return 0;
+        }
+        map = MapViewOfFile(cacheMapHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (map == NULL) {
+            unlockResultCache();
+            CloseHandle(cacheMapHandle);
+            CloseHandle(cacheFileHandle);
+            cacheMapHandle = NULL;
+            cacheFileHandle = INVALID_HANDLE_VALUE;
+            return 0;
+        }
+    #else
+        cacheFd = open(CACHE_FILE, O_RDWR | O_CREAT, 0644);
+        if (cacheFd < 0) return 0;
+        lockResultCache(1); // Another process may be creating or resetting the file right now
+        struct stat info;
+        // Wrong size: truncate and grow back, ftruncate zero-fills the new space
+        if (fstat(cacheFd, &info) != 0 || info.st_size != (off_t)size) {
+            if (ftruncate(cacheFd, 0) != 0 || ftruncate(cacheFd, size) != 0) {
+                close(cacheFd);
+                cacheFd = -1;
+                return 0;
+            }
+        }
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, cacheFd, 0);
+        if (map == MAP_FAILED) {
+            close(cacheFd);
+            cacheFd = -1;
+            return 0;
+        }
+    #endif
+
+    cacheHeader = (CacheHeader *)map;
+    resultCache = (CacheRecord *)(cacheHeader + 1);
+    if (memcmp(cacheHeader->magic, CACHE_MAGIC, 8) != 0 || cacheHeader->version != CACHE_VERSION ||
+        cacheHeader->recordSize != sizeof(CacheRecord) || cacheHeader->slots != CACHE_SLOTS) {
+        memset(map, 0, size);
+        memcpy(cacheHeader->magic, CACHE_MAGIC, 8);
+        cacheHeader->version = CACHE_VERSION;
+        cacheHeader->recordSize = sizeof(CacheRecord);
+        cacheHeader->slots = CACHE_SLOTS;
+    }
+    unlockResultCache();
+    return 1;
+}
+
+// Flushes and unmaps the cache file
+void closeResultCache() {
+    if (resultCache == NULL) return;
+    #ifdef _WIN32
+        FlushViewOfFile(cacheHeader, 0);
+        UnmapViewOfFile(cacheHeader);
+        CloseHandle(cacheMapHandle);
+        CloseHandle(cacheFileHandle);
+        cacheMapHandle = NULL;
+        cacheFileHandle = INVALID_HANDLE_VALUE;
+    #else
+        munmap(cacheHeader, cacheFileSize());
+        close(cacheFd);
+        cacheFd = -1;
+    #endif
+    cacheHeader = NULL;
+    resultCache = NULL;
+}
+
+// Cheap canonical labeling of the variables: each variable gets a signature built from how often it
+// occurs positively and negatively in clauses of each length, and the variables are relabeled in
+// signature order (ties broken by letter)
+// label[var] is the new index of var, or -1 if var is not used
+void canonicalLabeling(int C, char **clauses, int *label) {
+    int signature[26][8] = {{0}}; // [0..3] positive occurrences by clause length 1, 2, 3, 4+; [4..7] negative
+    int used = 0;
+    for (int i = 0; i < C; i++) {
+        int len = strlen(clauses[i]);
+        int bin = len < 4 ? len - 1 : 3;
+        for (int j = 0; j < len; j++) {
+            int var = varOf(clauses[i][j]);
+            signature[var][(isupper(clauses[i][j]) ? 4 : 0) + bin]++;
+            used |= 1 << var;
+        }
+    }
+
+    int order[26], n = 0;
+    for (int v = 0; v < 26; v++) {
+        label[v] = -1;
+        if (used & (1 << v)) order[n++] = v;
+    }
+
+    // Insertion sort by signature, stable so ties keep letter order
+    for (int i = 1; i < n; i++) {
+        int v = order[i], j = i - 1;
+        while (j >= 0 && memcmp(signature[order[j]], signature[v], sizeof(signature[v])) > 0) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = v;
+    }
+    for (int i = 0; i < n; i++) label[order[i]] = i;
+}
+
+// Identifies a formula in the cache
+typedef struct {
+    uint64_t key, check;
+    uint32_t keyLength;
+} CacheKey;
+
+// Computes the cache key of a formula and the labeling its model is stored under
+CacheKey resultCacheKey(int C, char **clauses, int *label) {
+    char **renamed = malloc(C * sizeof(char *));
+    if (useCache == 2) {
+        canonicalLabeling(C, clauses, label);
+    } else {
+        for (int v = 0; v < 26; v++) label[v] = v;
+    }
+    for (int i = 0; i < C; i++) {
+        renamed[i] = strdup(clauses[i]);
+        for (int j = 0; renamed[i][j] != '\0'; j++) {
+            char base = islower(renamed[i][j]) ? 'a' : 'A';
+            renamed[i][j] = base + label[varOf(renamed[i][j])];
+        }
+    }
+
+    char *key = canonicalKey(renamed, C);
+    CacheKey result;
+    result.key = hashString64(key, 14695981039346656037ULL) ^ (uint64_t)useCache; // Exact and renamed keys never collide
+    result.check = hashString64(key, 0x9E3779B97F4A7C15ULL) ^ (uint64_t)useCache;
+    result.keyLength = (uint32_t)strlen(key);
+
+    free(key);
+    for (int i = 0; i < C; i++) free(renamed[i]);
+    free(renamed);
+    return result;
+}
+
+// Returns 1 if a slot holds the given formula
+int cacheSlotMatches(CacheRecord *slot, CacheKey *key) {
+    return slot->status != CACHE_EMPTY && slot->key == key->key &&
+           slot->check == key->check && slot->keyLength == key->keyLength;
+}
+
+// Returns the slot holding key, or NULL if it is not cached
+CacheRecord *findCacheSlot(CacheKey *key) {
+    for (int probe = 0; probe < CACHE_PROBES; probe++) {
+        CacheRecord *slot = &resultCache[(key->key + probe) % CACHE_SLOTS];
+        if (slot->status == CACHE_EMPTY) return NULL;
+        if (cacheSlotMatches(slot, key)) return slot;
+    }
+    return NULL;
+}
+
+// Returns the slot to store key in: its current slot, else the first empty one among its probes,
+// else its home slot (the old entry there is replaced)
+CacheRecord *insertCacheSlot(CacheKey *key) {
+    for (int probe = 0; probe < CACHE_PROBES; probe++) {
+        CacheRecord *slot = &resultCache[(key->key + probe) % CACHE_SLOTS];
+        if (slot->status == CACHE_EMPTY || cacheSlotMatches(slot, key)) return slot;
+    }
+    return &resultCache[key->key % CACHE_SLOTS];
+}
+
+// Looks the formula up in the result cache
+// Returns 1 (SAT, model written to assignments), 0 (UNSAT) or -1 on a miss
+int cacheLookup(int C, char **clauses, int *assignments) {
+    if (!openResultCache()) return -1;
+
+    int label[26];
+    CacheKey key = resultCacheKey(C, clauses, label);
+    // Copy the record out under the lock, then work on the copy
+    lockResultCache(0);
+    CacheRecord *slot = findCacheSlot(&key);
+    CacheRecord record;
+    if (slot != NULL) record = *slot;
+    unlockResultCache();
+    if (slot == NULL) return -1;
+    if (record.status == CACHE_UNSAT) return 0;
+
+    for (int v = 0; v < 26; v++) {
+        assignments[v] = label[v] >= 0 ? record.model[label[v]] : 0;
+    }
+    // A model that does not check out (hash collision, ambiguous labeling) is treated as a miss
+    if (!is_satisfied(clauses, C, assignments, 26)) {
+        memset(assignments, 0, 26 * sizeof(int));
+        return -1;
+    }
+    return 1;
+}
+
+// Stores a solved formula in the result cache
+void cacheStore(int C, char **clauses, int sat, int *assignments) {
+    if (!openResultCache()) return;
+
+    int label[26];
+    CacheKey key = resultCacheKey(C, clauses, label);
+    lockResultCache(1);
+    CacheRecord *slot = insertCacheSlot(&key);
+
+    // The status goes last, so a store cut short (process killed) leaves an empty slot, not a torn record
+    slot->status = CACHE_EMPTY;
+    memset(slot->model, 0, sizeof(slot->model));
+    if (sat) {
+        for (int v = 0; v < 26; v++) {
+            if (label[v] >= 0) slot->model[label[v]] = (signed char)assignments[v];
+        }
+    }
+    slot->key = key.key;
+    slot->check = key.check;
+    slot->keyLength = key.keyLength;
+    slot->status = sat ? CACHE_SAT : CACHE_UNSAT;
+    unlockResultCache();
+}
+
+// === Parallel resolution ===
+// Saturation runs in rounds; within a round the clause set is read-only, so the pairs can be split
+// across threads that each write their resolvents to a private buffer
+// The buffers are then sorted and merged into the shared clause set by one thread, which makes the
+// result (and the printed trace) the same for any number of threads
+
+#define MAX_THREADS 64
+
+// A resolvent together with the indices of the clauses it came from
+typedef struct {
+    char *clause;
+    int left, right;
+} Resolvent;
+
+// Growable clause list plus a hash set over it for duplicate checks
+typedef struct {
+    char **clauses;
+    int total, capacity;
+    char **table;   // Open addressing, NULL = empty slot
+    int tableSize;
+    OccIndex occ;
+} ClauseSet;
+
+// Returns 1 if the set already holds the clause (clauses are stored in canonical form)
+int clauseSetContains(ClauseSet *set, const char *clause) {
+    unsigned long slot = hashString(clause) % set->tableSize;
+    while (set->table[slot] != NULL) {
+        if (strcmp(set->table[slot], clause) == 0) return 1;
+        slot = (slot + 1) % set->tableSize;
+    }
+    return 0;
+}
+
+// Adds a canonical clause to the set, taking ownership of it
+// Only called between rounds, while no worker threads are running
+void clauseSetAdd(ClauseSet *set, char *clause) {
+    if (set->total == set->capacity) {
+        set->capacity *= 2;
+        set->clauses = realloc(set->clauses, set->capacity * sizeof(char *));
+    }
+    occAddClause(&set->occ, set->total, clause);
+    set->clauses[set->total++] = clause;
+
+    // Keep the table at most half full
+    if (set->total * 2 > set->tableSize) {
+        free(set->table);
+        set->tableSize *= 2;
+        set->table = calloc(set->tableSize, sizeof(char *));
+        for (int i = 0; i < set->total; i++) {
+            unsigned long slot = hashString(set->clauses[i]) % set->tableSize;
+            while (set->table[slot] != NULL) slot = (slot + 1) % set->tableSize;
+            set->table[slot] = set->clauses[i];
+        }
+        return;
+    }
+    unsigned long slot = hashString(clause) % set->tableSize;
+    while (set->table[slot] != NULL) slot = (slot + 1) % set->tableSize;
+    set->table[slot] = clause;
+}
+
+// Resolves two clauses on lit and returns the resolvent in canonical form (sorted, no duplicates)
+// Returns NULL if the resolvent is a tautology (contains some x and X), since it can never help
+char *resolveCanonical(const char *clause1, const char *clause2, char lit) {
+    int len1 = strlen(clause1), len2 = strlen(clause2);
+    char *resolvent = malloc(len1 + len2 + 1);
+    int k = 0;
+    for (int i = 0; i < len1; i++) {
+        if (clause1[i] != lit) resolvent[k++] = clause1[i];
+    }
+    for (int i = 0; i < len2; i++) {
+        if (clause2[i] != negate(lit)) resolvent[k++] = clause2[i];
+    }
+    qsort(resolvent, k, 1, compareChars);
+
+    int n = 0;
+    for (int i = 0; i < k; i++) {
+        if (n > 0 && resolvent[n - 1] == resolvent[i]) continue;
+        resolvent[n++] = resolvent[i];
+    }
+    resolvent[n] = '\0';
+
+    for (int i = 0; i < n; i++) {
+        if (clauseContains(resolvent, negate(resolvent[i]))) {
+            free(resolvent);
+            return NULL;
+        }
+    }
+    return resolvent;
+}
+
+// Orders resolvents by clause, then by parents, so the merge does not depend on thread timing
+int compareResolvents(const void *a, const void *b) {
+    const Resolvent *r1 = a, *r2 = b;
+    int cmp = strcmp(r1->clause, r2->clause);
+    if (cmp != 0) return cmp;
+    if (r1->left != r2->left) return r1->left - r2->left;
+    return r1->right - r2->right;
+}
+
+// Counter the workers of a round add to concurrently
+#ifdef _WIN32
+    typedef volatile LONG64 SharedCounter;
+#else
+    typedef atomic_long SharedCounter;
+#endif
+
+// Adds n to the counter and returns its previous value
+long sharedAdd(SharedCounter *counter, long n) {
+    #ifdef _WIN32
+        return (long)InterlockedExchangeAdd64(counter, n);
+    #else
+        return atomic_fetch_add(counter, n);
+    #endif
+}
+
+// Resolvents and bytes claimed so far by all the workers of a round
+typedef struct {
+    SharedCounter resolvents, bytes;
+} RoundBudget;
+
+// Work description for one resolution thread
+typedef struct {
+    ClauseSet *set;
+    int roundStart;   // First clause added in the previous round
+    int thread, numThreads;
+    Resolvent *buffer;
+    int count, capacity;
+    long resolvents, bytes; // Work done this round, added to usage once the round is over
+    RoundBudget *shared;
+    const char *stopped;    // Budget that ran out mid-round, NULL otherwise
+} ResolutionWorker;
+
+// Resolves every pair (i, j) with i < j and j >= roundStart, taking the j's with j % numThreads == thread
+// Pairs of two old clauses were already resolved in an earlier round
+// The partners i of clause j come from the occurrence lists of its negated literals
+// Every resolvent is claimed on the round's shared counters first; a claim that would take usage past
+// the resolvent or byte budget stops the worker, and such a round is thrown away
+// A round is cut short exactly when its resolvents do not fit in what is left, for any number of threads
+void *resolutionWorker(void *arg) {
+    ResolutionWorker *w = arg;
+    ClauseSet *set = w->set;
+
+    for (int j = w->roundStart + w->thread; j < set->total; j += w->numThreads) {
+        if (budgetTimeUp()) {
+            w->stopped = "time";
+            return NULL;
+        }
+        for (int k = 0; set->clauses[j][k] != '\0'; k++) {
+            char lit = set->clauses[j][k];
+            OccList *clashing = occurrences(&set->occ, negate(lit));
+            for (int x = 0; x < clashing->count && clashing->ids[x] < j; x++) {
+                int i = clashing->ids[x];
+
+                char *res = resolveCanonical(set->clauses[j], set->clauses[i], lit);
+                if (res == NULL) continue;
+                long bytes = strlen(res) + 1;
+                if (budget.resolvents > 0 &&
+                    usage.resolvents + sharedAdd(&w->shared->resolvents, 1) >= budget.resolvents) {
+                    w->stopped = "resolvents";
+                } else if (budget.bytes > 0 &&
+                           usage.bytes + sharedAdd(&w->shared->bytes, bytes) + bytes > budget.bytes) {
+                    w->stopped = "memory";
+                }
+                if (w->stopped != NULL) {
+                    free(res);
+                    return NULL;
+                }
+                w->resolvents++;
+                w->bytes += bytes;
+                if (clauseSetContains(set, res)) { // Read-only lookup, safe while all threads only read
+                    free(res);
+                    continue;
+                }
+                if (w->count == w->capacity) {
+                    w->capacity = w->capacity ? w->capacity * 2 : 64;
+                    w->buffer = realloc(w->buffer, w->capacity * sizeof(Resolvent));
+                }
+                w->buffer[w->count].clause = res;
+                w->buffer[w->count].left = i;
+                w->buffer[w->count].right = j;
+                w->count++;
+            }
+        }
+    }
+    return NULL;
+}
+
+#ifdef _WIN32
+// CreateThread expects a WINAPI (stdcall) routine, so the worker cannot be passed to it directly
+DWORD WINAPI resolutionThread(LPVOID arg) {
+    resolutionWorker(arg);
+    return 0;
+}
+#endif
+
+// Runs one round's workers, in parallel when more than one thread is requested
+// A worker whose thread cannot be created runs on the calling thread instead
+void runResolutionWorkers(ResolutionWorker *workers, int numThreads) {
+    if (numThreads == 1) {
+        resolutionWorker(&workers[0]);
+        return;
+    }
+    int *started = calloc(numThreads, sizeof(int));
+    #ifdef _WIN32
+        HANDLE *threads = malloc(numThreads * sizeof(HANDLE));
+        for (int t = 0; t < numThreads; t++) {
+            threads[t] = CreateThread(NULL, 0, resolutionThread, &workers[t], 0, NULL);
+            started[t] = threads[t] != NULL;
+        }
+        for (int t = 0; t < numThreads; t++) {
+            if (!started[t]) resolutionWorker(&workers[t]);
+        }
+        for (int t = 0; t < numThreads; t++) {
+            if (!started[t]) continue;
+            WaitForSingleObject(threads[t], INFINITE);
+            CloseHandle(threads[t]);
+        }
+    #else
+        pthread_t *threads = malloc(numThreads * sizeof(pthread_t));
+        for (int t = 0; t < numThreads; t++) {
+            started[t] = pthread_create(&threads[t], NULL, resolutionWorker, &workers[t]) == 0;
+        }
+        for (int t = 0; t < numThreads; t++) {
+            if (!started[t]) resolutionWorker(&workers[t]);
+        }
+        for (int t = 0; t < numThreads; t++) {
+            if (started[t]) pthread_join(threads[t], NULL);
+        }
+    #endif
+    free(threads);
+    free(started);
+}
+
+// Saturation state kept when parallelResolution() stops on a budget, so the next run on the same
+// clauses continues from the last completed round instead of starting over
+typedef struct {
+    char *key;        // Canonical form of the input clauses, NULL if there is no checkpoint
+    ClauseSet set;
+    int roundStart, round;
+} ResolutionCheckpoint;
+
+ResolutionCheckpoint checkpoint = {NULL};
+
+// Drops the saved saturation state
+void clearCheckpoint() {
+    if (checkpoint.key == NULL) return;
+    for (int i = 0; i < checkpoint.set.total; i++) free(checkpoint.set.clauses[i]);
+    free(checkpoint.set.clauses);
+    free(checkpoint.set.table);
+    occFree(&checkpoint.set.occ);
+    free(checkpoint.key);
+    checkpoint.key = NULL;
+}
+
+// Resolution saturation split across numThreads threads
+// Same outcome as resolution(), but tautologies are dropped and the clause set grows as needed
+// A run stopped by a budget can be resumed by running it again on the same clauses
+void parallelResolution(int C, char **clauses, int numThreads) {
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+    ClauseSet set;
+    int roundStart = 0, round = 0, unsat = 0;
+    char *key = canonicalKey(clauses, C);
+    budgetStart();
+
+    if (checkpoint.key != NULL && strcmp(checkpoint.key, key) == 0) {
+        set = checkpoint.set;
+        roundStart = checkpoint.roundStart;
+        round = checkpoint.round;
+        free(checkpoint.key);
+        checkpoint.key = NULL;
+        printf("Resuming saturation after round %d with %d clause(s).\n", round, set.total);
+    } else {
+        clearCheckpoint(); // Saved state of another formula
+        set.capacity = C > 16 ? C : 16;
+        set.clauses = malloc(set.capacity * sizeof(char *));
+        set.total = 0;
+        set.tableSize = 64;
+        set.table = calloc(set.tableSize, sizeof(char *));
+        occInit(&set.occ);
+
+        for (int i = 0; i < C; i++) {
+            char *clause = canonicalKey(&clauses[i], 1);
+            clause[strlen(clause) - 1] = '\0'; // Drop the trailing ','
+            if (clauseSetContains(&set, clause)) free(clause);
+            else clauseSetAdd(&set, clause);
+        }
+    }
+
+    ResolutionWorker *workers = calloc(numThreads, sizeof(ResolutionWorker));
+    RoundBudget shared;
+
+    while (roundStart < set.total && !unsat) {
+        int count = 0;
+        const char *stopped = NULL;
+        shared.resolvents = 0;
+        shared.bytes = 0;
+        for (int t = 0; t < numThreads; t++) {
+            workers[t].set = &set;
+            workers[t].roundStart = roundStart;
+            workers[t].thread = t;
+            workers[t].numThreads = numThreads;
+            workers[t].count = 0;
+            workers[t].resolvents = 0;
+            workers[t].bytes = 0;
+            workers[t].shared = &shared;
+            workers[t].stopped = NULL;
+        }
+        runResolutionWorkers(workers, numThreads);
+
+        // A round cut short is thrown away, so a resumed run redoes it from the start
+        for (int t = 0; t < numThreads; t++) {
+            usage.resolvents += workers[t].resolvents;
+            usage.bytes += workers[t].bytes;
+            if (stopped == NULL) stopped = workers[t].stopped;
+        }
+        if (stopped != NULL) {
+            for (int t = 0; t < numThreads; t++) {
+                for (int i = 0; i < workers[t].count; i++) free(workers[t].buffer[i].clause);
+            }
+            usage.exhausted = stopped;
+            break;
+        }
+        round++;
+
+        // Merge: gather all buffers, sort, and add each new clause once
+        for (int t = 0; t < numThreads; t++) count += workers[t].count;
+        Resolvent *merged = malloc((count > 0 ? count : 1) * sizeof(Resolvent));
+        int m = 0;
+        for (int t = 0; t < numThreads; t++) {
+            if (workers[t].count == 0) continue; // buffer may still be NULL
+            memcpy(merged + m, workers[t].buffer, workers[t].count * sizeof(Resolvent));
+            m += workers[t].count;
+        }
+        qsort(merged, count, sizeof(Resolvent), compareResolvents);
+
+        roundStart = set.total;
+        int added = 0;
+        const char *last = NULL; // Last clause kept; duplicates are freed, so never compare with merged[i - 1]
+        for (int i = 0; i < count; i++) {
+            if (unsat || (last != NULL && strcmp(merged[i].clause, last) == 0)) {
+                free(merged[i].clause);
+                continue;
+            }
+            // The empty clause sorts first
+            if (merged[i].clause[0] == '\0') {
+                printf("Derived empty clause from [%s] and [%s].\n",
+                       set.clauses[merged[i].left], set.clauses[merged[i].right]);
+                printf("The formula is UNSAT.\n");
+                unsat = 1;
+                free(merged[i].clause);
+                continue;
+            }
+            clauseSetAdd(&set, merged[i].clause);
+            last = merged[i].clause;
+            added++;
+        }
+        free(merged);
+
+        if (!unsat) {
+            printf("Round %d: %d new clause(s), %d in total.\n", round, added, set.total);
+            // Stopping between rounds keeps the completed round in the checkpoint
+            if (roundStart < set.total && budgetTimeUp()) {
+                usage.exhausted = "time";
+                break;
+            }
+        }
+    }
+
+    for (int t = 0; t < numThreads; t++) free(workers[t].buffer);
+    free(workers);
+
+    if (usage.exhausted != NULL && !unsat) {
+        budgetReport();
+        printf("Run it again on the same clauses to resume.\n");
+        checkpoint.key = key;
+        checkpoint.set = set;
+        checkpoint.roundStart = roundStart;
+        checkpoint.round = round;
+        return;
+    }
+
+    if (!unsat) printf("\nNo empty clause found after saturation. The formula is SAT.\n");
+
+    free(key);
+    for (int i = 0; i < set.total; i++) free(set.clauses[i]);
+    free(set.clauses);
+    free(set.table);
+    occFree(&set.occ);
+}
+
 // Davis-Putnam algorithm for SAT solving
 // It uses unit propagation and backtracking to find a satisfying assignment
 void dp(int C, char **clauses, int ll) {
@@ -290,11 +1359,29 @@ void dp(int C, char **clauses, int ll) {
     int maxVars = 26;
     int assignments[maxVars];
     memset(assignments, 0, sizeof(assignments));
+    budgetStart();
 
     // === DPLL Shortcut Mode ===
     if (ll == 0) {
-        if (dpll(clauses, C, assignments, maxVars)) {
+        int sat = useCache ? cacheLookup(C, clauses, assignments) : -1;
+        if (sat != -1) {
+            printf("Result cache hit.\n");
+        } else {
+            sat = dpll(clauses, C, assignments, maxVars);
+            if (useCache && sat != SAT_UNKNOWN) cacheStore(C, clauses, sat, assignments);
+        }
+
+        if (sat == SAT_UNKNOWN) {
+            budgetReport();
+        } else if (sat) {
             printf("The formula is SAT.\n");
+            int used = 0;
+            for (int i = 0; i < C; i++) used |= clauseMask(clauses[i]);
+            printf("Satisfying assignment:\n");
+            for (int i = 0; i < maxVars; i++) {
+                // Unassigned variables count as false (see is_satisfied)
+                if (used & (1 << i)) printf("%c = %s\n", 'a' + i, assignments[i] == 1 ? "true" : "false");
+            }
         } else {
             printf("The formula is UNSAT.\n");
         }
@@ -308,95 +1395,111 @@ void dp(int C, char **clauses, int ll) {
     }
 
     // === Unit Propagation Mode ===
+    // Clauses are simplified in place; working[i] == NULL means clause i has been removed
+    // Assigning lit only touches the clauses in the occurrence lists of lit and its negation
     char **working = malloc(C * sizeof(char *));
+    int *units = malloc(C * sizeof(int)); // Clauses that may have become unit
+    int numUnits = 0;
+    OccIndex occ;
+    occInit(&occ);
     for (int i = 0; i < C; i++) {
         working[i] = strdup(clauses[i]);
+        occAddClause(&occ, i, working[i]);
+        if (strlen(working[i]) == 1) units[numUnits++] = i;
     }
-    int numClauses = C;
+    int numClauses = C, firstAlive = 0, result = 1;
 
     while (numClauses > 0) {
-        bool unitFound = false;
+        // Stop with UNKNOWN once a budget runs out
+        if (budgetExceeded()) {
+            budgetReport();
+            result = SAT_UNKNOWN;
+            break;
+        }
+
         char lit = '\0';
 
         // Find unit clause
-        for (int i = 0; i < numClauses; i++) {
-            if (strlen(working[i]) == 1) {
-                lit = working[i][0];
-                unitFound = true;
-                break;
+        while (numUnits > 0 && lit == '\0') {
+            int id = units[--numUnits];
+            if (working[id] != NULL && strlen(working[id]) == 1) lit = working[id][0];
+        }
+
+        // Otherwise look for a pure literal: it occurs, but its negation does not
+        for (int i = 0; i < 52 && lit == '\0'; i++) {
+            char candidate = indexLit(i);
+            if (occ.lists[i].count > 0 && occurrences(&occ, negate(candidate))->count == 0) {
+                lit = candidate;
+                printf("Literal %c is pure.\n", lit);
             }
         }
 
-        // If no unit clause, pick arbitrary literal
-        if (!unitFound) {
-            lit = working[0][0];
+        // If no unit clause or pure literal, pick arbitrary literal
+        if (lit == '\0') {
+            while (working[firstAlive] == NULL) firstAlive++;
+            lit = working[firstAlive][0];
+            if (!budgetDecision()) {
+                budgetReport();
+                result = SAT_UNKNOWN;
+                break;
+            }
         }
 
         char neg = negate(lit);
-        char **newClauses = malloc(numClauses * sizeof(char *));
-        int newCount = 0;
-
-        for (int i = 0; i < numClauses; i++) {
-            char *clause = working[i];
-
-            // Clause is satisfied by literal → discard
-            if (clauseContains(clause, lit)) {
-                printf("Clause ");
-                printClause(clause);
-                printf(" is satisfied by literal %c. Removing.\n", lit);
-                free(clause);
-                continue;
-            }
 
-            // Remove negated literal
-            int len = strlen(clause);
-            char *newClause = malloc(len + 1);
-            int k = 0;
-            for (int j = 0; j < len; j++) {
-                if (clause[j] != neg) {
-                    newClause[k++] = clause[j];
-                }
-            }
-            newClause[k] = '\0';
+        // Clauses satisfied by literal → discard
+        OccList *satisfied = occurrences(&occ, lit);
+        while (satisfied->count > 0) {
+            int id = satisfied->ids[0];
+            printf("Clause ");
+            printClause(working[id]);
+            printf(" is satisfied by literal %c. Removing.\n", lit);
+            occRemoveClause(&occ, id, working[id]);
+            free(working[id]);
+            working[id] = NULL;
+            numClauses--;
+        }
+
+        // Remove negated literal from the clauses containing it
+        OccList *clashing = occurrences(&occ, neg);
+        while (clashing->count > 0 && result == 1) {
+            int id = clashing->ids[0];
+            char *clause = working[id];
+            occRemoveLiteral(&occ, id, neg);
 
             printf("Simplifying clause ");
             printClause(clause);
+            int k = 0;
+            for (int j = 0; clause[j] != '\0'; j++) {
+                if (clause[j] != neg) clause[k++] = clause[j];
+            }
+            clause[k] = '\0';
             printf(" by removing %c (negation of %c). Result: ", neg, lit);
-            printClause(newClause);
+            printClause(clause);
             printf("\n");
 
-            free(clause); // free old clause
-
             // Empty clause → UNSAT
             if (k == 0) {
-                printf("Derived empty clause by assigning %c. Conflict found. Formula is UNSAT.\n\n", lit);
-
-                // Cleanup
-                free(newClause);
-                for (int x = 0; x < newCount; x++) free(newClauses[x]);
-                free(newClauses);
-                for (int x = i + 1; x < numClauses; x++) free(working[x]);
-                free(working);
-
-                printf("Press Enter to continue...\n");
-                while ((getchar()) != '\n' && getchar() != EOF);
-                getchar();
-                clearTerminal();
-                return;
+                if (!budgetConflict()) {
+                    budgetReport();
+                    result = SAT_UNKNOWN;
+                } else {
+                    printf("Derived empty clause by assigning %c. Conflict found. Formula is UNSAT.\n\n", lit);
+                    result = 0;
+                }
+            } else if (k == 1) {
+                units[numUnits++] = id;
             }
-
-            newClauses[newCount++] = newClause;
         }
-
-        free(working);
-        working = newClauses;
-        numClauses = newCount;
+        if (result != 1) break;
     }
 
     // If loop completes: SAT
-    printf("No conflict found. Formula is SAT.\n\n");
-    for (int i = 0; i < numClauses; i++) free(working[i]);
+    if (result == 1) printf("No conflict found. Formula is SAT.\n\n");
+    for (int i = 0; i < C; i++) free(working[i]);
     free(working);
+    free(units);
+    occFree(&occ);
 
     printf("Press Enter to continue...\n");
     while ((getchar()) != '\n' && getchar() != EOF);
@@ -404,6 +1507,627 @@ void dp(int C, char **clauses, int ll) {
     clearTerminal();
 }
 
+// Decision-based model enumeration (no blocking clauses needed)
+// Branches on vars[depth], vars[depth + 1], ... in order and cuts a branch as soon as a clause is falsified
+// Once every clause is satisfied the remaining variables are don't-cares, so each printed line is a cube of models
+// Returns the number of models below this node (only those found so far if a budget runs out)
+unsigned long long enumerate(char **clauses, int C, int *assignments, int *vars, int numVars, int depth, int *cubes) {
+    if (budgetExceeded()) return 0;
+
+    int allSatisfied = 1;
+    for (int i = 0; i < C; i++) {
+        int status = clauseStatus(clauses[i], assignments);
+        if (status == -1) {
+            budgetConflict();
+            return 0; // Conflict, prune this branch
+        }
+        if (status == 0) allSatisfied = 0;
+    }
+
+    if (allSatisfied) {
+        (*cubes)++;
+        printf("Model %d: ", *cubes);
+        for (int i = 0; i < numVars; i++) {
+            int v = assignments[vars[i]];
+            printf("%c=%c ", 'a' + vars[i], v == 1 ? '1' : (v == -1 ? '0' : '*'));
+        }
+        printf("\n");
+        return 1ULL << (numVars - depth);
+    }
+
+    int var = vars[depth];
+    unsigned long long total = 0;
+    if (!budgetDecision()) return 0;
+    assignments[var] = 1;
+    total += enumerate(clauses, C, assignments, vars, numVars, depth + 1, cubes);
+    assignments[var] = -1;
+    total += enumerate(clauses, C, assignments, vars, numVars, depth + 1, cubes);
+    assignments[var] = 0; // Backtrack
+    return total;
+}
+
+// Prints every satisfying assignment of the formula
+// '*' marks a variable that can take either value in that model
+void enumerateModels(int C, char **clauses) {
+    int mask = 0;
+    for (int i = 0; i < C; i++) mask |= clauseMask(clauses[i]);
+
+    int vars[26], numVars = 0;
+    for (int i = 0; i < 26; i++) {
+        if (mask & (1 << i)) vars[numVars++] = i;
+    }
+
+    int assignments[26];
+    memset(assignments, 0, sizeof(assignments));
+    int cubes = 0;
+    budgetStart();
+
+    unsigned long long total = enumerate(clauses, C, assignments, vars, numVars, 0, &cubes);
+    if (usage.exhausted != NULL) {
+        printf("\n%llu model(s) found before stopping.\n", total);
+        budgetReport();
+    } else if (total == 0) {
+        printf("No models. The formula is UNSAT.\n");
+    } else {
+        printf("\n%llu model(s) over %d variable(s), listed as %d line(s).\n", total, numVars, cubes);
+    }
+}
+
+// A cached component count, chained by hash bucket
+typedef struct ComponentEntry {
+    char *key;
+    unsigned long long count;
+    struct ComponentEntry *next;
+} ComponentEntry;
+
+#define COMPONENT_CACHE_SIZE 4096
+
+// Component counts only depend on the canonical component, so the cache is kept between runs
+ComponentEntry *componentCache[COMPONENT_CACHE_SIZE];
+
+// Frees every entry of the component cache
+void clearComponentCache() {
+    for (int i = 0; i < COMPONENT_CACHE_SIZE; i++) {
+        ComponentEntry *entry = componentCache[i];
+        while (entry != NULL) {
+            ComponentEntry *next = entry->next;
+            free(entry->key);
+            free(entry);
+            entry = next;
+        }
+        componentCache[i] = NULL;
+    }
+}
+
+// Assigns a literal to true: drops the clauses it satisfies and removes its negation from the rest
+// Returns the new clause list, or NULL if an empty clause was produced (conflict)
+char **assignLiteral(char **clauses, int C, char lit, int *newC) {
+    char neg = negate(lit);
+    char **result = malloc((C > 0 ? C : 1) * sizeof(char *));
+    int count = 0;
+
+    for (int i = 0; i < C; i++) {
+        if (clauseContains(clauses[i], lit)) continue;
+
+        int len = strlen(clauses[i]);
+        char *clause = malloc(len + 1);
+        int k = 0;
+        for (int j = 0; j < len; j++) {
+            if (clauses[i][j] != neg) clause[k++] = clauses[i][j];
+        }
+        clause[k] = '\0';
+
+        if (k == 0) {
+            free(clause);
+            for (int x = 0; x < count; x++) free(result[x]);
+            free(result);
+            return NULL;
+        }
+        result[count++] = clause;
+    }
+
+    *newC = count;
+    return result;
+}
+
+unsigned long long countComponent(char **clauses, int C, int mask);
+
+// Counts the models of a clause set over the variables in mask
+// The clauses are split into connected components (clauses sharing a variable), each one is counted
+// on its own and the counts are multiplied; variables in mask that no clause uses double the count
+unsigned long long countFormula(char **clauses, int C, int mask) {
+    int used = 0;
+    for (int i = 0; i < C; i++) used |= clauseMask(clauses[i]);
+
+    int *component = malloc((C > 0 ? C : 1) * sizeof(int));
+    char **members = malloc((C > 0 ? C : 1) * sizeof(char *));
+    for (int i = 0; i < C; i++) component[i] = -1;
+
+    unsigned long long total = 1;
+    int numComponents = 0;
+    for (int start = 0; start < C && total > 0; start++) {
+        if (component[start] != -1) continue;
+
+        // Grow the component until no remaining clause shares one of its variables
+        int compMask = clauseMask(clauses[start]);
+        component[start] = numComponents;
+        int grown = 1;
+        while (grown) {
+            grown = 0;
+            for (int i = start + 1; i < C; i++) {
+                if (component[i] == -1 && (clauseMask(clauses[i]) & compMask)) {
+                    component[i] = numComponents;
+                    compMask |= clauseMask(clauses[i]);
+                    grown = 1;
+                }
+            }
+        }
+
+        int n = 0;
+        for (int i = start; i < C; i++) {
+            if (component[i] == numComponents) members[n++] = clauses[i];
+        }
+        total *= countComponent(members, n, compMask);
+        numComponents++;
+    }
+
+    free(component);
+    free(members);
+    return total << countBits(mask & ~used);
+}
+
+// Counts the models of one connected component over its own variables
+// Results are cached under the canonical form of the component
+// Returns 0 if a budget runs out; partial counts are never cached
+unsigned long long countComponent(char **clauses, int C, int mask) {
+    if (budgetExceeded()) return 0;
+
+    char *key = canonicalKey(clauses, C);
+    unsigned long bucket = hashString(key) % COMPONENT_CACHE_SIZE;
+    for (ComponentEntry *entry = componentCache[bucket]; entry != NULL; entry = entry->next) {
+        if (strcmp(entry->key, key) == 0) {
+            free(key);
+            return entry->count;
+        }
+    }
+
+    // Branch on the variable with the most occurrences
+    int varCount[26] = {0};
+    for (int i = 0; i < C; i++) {
+        for (int j = 0; clauses[i][j] != '\0'; j++) varCount[varOf(clauses[i][j])]++;
+    }
+    int var = 0;
+    for (int i = 1; i < 26; i++) {
+        if (varCount[i] > varCount[var]) var = i;
+    }
+
+    unsigned long long count = 0;
+    char lits[2] = {'a' + var, 'A' + var};
+    if (!budgetDecision()) {
+        free(key);
+        return 0;
+    }
+    for (int b = 0; b < 2 && usage.exhausted == NULL; b++) {
+        int newC;
+        char **reduced = assignLiteral(clauses, C, lits[b], &newC);
+        if (reduced == NULL) {
+            budgetConflict();
+            continue; // Conflict, no models on this side
+        }
+        long bytes = 0;
+        for (int i = 0; i < newC; i++) bytes += strlen(reduced[i]) + 1;
+        if (budgetBytes(bytes)) count += countFormula(reduced, newC, mask & ~(1 << var));
+        for (int i = 0; i < newC; i++) free(reduced[i]);
+        free(reduced);
+    }
+
+    if (usage.exhausted != NULL) {
+        free(key);
+        return 0;
+    }
+
+    ComponentEntry *entry = malloc(sizeof(ComponentEntry));
+    entry->key = key;
+    entry->count = count;
+    entry->next = componentCache[bucket];
+    componentCache[bucket] = entry;
+    return count;
+}
+
+// #SAT: prints the number of models of the formula over the variables it uses
+void countModels(int C, char **clauses) {
+    int mask = 0;
+    for (int i = 0; i < C; i++) mask |= clauseMask(clauses[i]);
+
+    budgetStart();
+    unsigned long long count = countFormula(clauses, C, mask);
+    if (usage.exhausted != NULL) {
+        budgetReport();
+        return;
+    }
+    printf("The formula has %llu model(s) over %d variable(s).\n", count, countBits(mask));
+    if (count == 0) printf("The formula is UNSAT.\n");
+}
+
+// === Symmetry breaking ===
+// The CNF is turned into a colored graph: two literal nodes per variable (joined by an edge) and one
+// node per clause, joined to its literals. Automorphisms of that graph are symmetries of the formula.
+// They are found with partition refinement plus individualization (the nauty scheme, kept small), then
+// each generator adds lex-leader clauses that only keep the lexicographically smallest model of each orbit
+
+#define SYM_NODE_LIMIT 2000   // Search tree nodes tried per candidate vertex
+#define SYM_MAX_GENERATORS 64
+#define SBP_DEPTH 4           // Lex-leader positions encoded per generator (2^i clauses for position i)
+
+typedef struct {
+    int n;              // Literal nodes first, then clause nodes
+    int numLitNodes;
+    int *adjStart, *adj; // Neighbours of v are adj[adjStart[v] .. adjStart[v + 1])
+    char *matrix;        // n * n adjacency matrix, used to check a candidate automorphism
+    int *initial;        // 0 for literal nodes, 1 for clause nodes
+    char nodeLit[52];    // Literal of each literal node
+} SymGraph;
+
+// First path of the search tree: the refined coloring at each level and the vertex individualized there
+typedef struct {
+    int length;         // Number of individualizations; colors[length] is discrete
+    int **colors;
+    int *cells;         // Number of cells of colors[level]
+    int *target;        // Cell split at each level
+    int *chosen;        // Vertex individualized at each level
+} SymPath;
+
+// Signatures used while sorting vertices in refine() (qsort has no context argument)
+int *symSig, *symSigStart, *symSigLen;
+
+int compareInts(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// Orders vertices by their signature (own color, then sorted neighbour colors)
+int compareSignatures(const void *a, const void *b) {
+    int u = *(const int *)a, v = *(const int *)b;
+    int len = symSigLen[u] < symSigLen[v] ? symSigLen[u] : symSigLen[v];
+    for (int i = 0; i < len; i++) {
+        int diff = symSig[symSigStart[u] + i] - symSig[symSigStart[v] + i];
+        if (diff != 0) return diff;
+    }
+    return symSigLen[u] - symSigLen[v];
+}
+
+// Refines a coloring until it is equitable (every vertex of a cell sees the same number of neighbours
+// of each color). Colors are renumbered by signature rank only, so isomorphic inputs give matching cells.
+// Returns the number of cells
+int refine(SymGraph *g, int *color) {
+    int n = g->n;
+    int *order = malloc(n * sizeof(int));
+    int *next = malloc(n * sizeof(int));
+    symSig = malloc((n + g->adjStart[n]) * sizeof(int));
+    symSigStart = malloc(n * sizeof(int));
+    symSigLen = malloc(n * sizeof(int));
+
+    int cells = -1;
+    while (1) {
+        int pos = 0;
+        for (int v = 0; v < n; v++) {
+            symSigStart[v] = pos;
+            symSig[pos++] = color[v];
+            for (int e = g->adjStart[v]; e < g->adjStart[v + 1]; e++) symSig[pos++] = color[g->adj[e]];
+            qsort(symSig + symSigStart[v] + 1, pos - symSigStart[v] - 1, sizeof(int), compareInts);
+            symSigLen[v] = pos - symSigStart[v];
+            order[v] = v;
+        }
+        qsort(order, n, sizeof(int), compareSignatures);
+
+        int k = 0;
+        next[order[0]] = 0;
+        for (int i = 1; i < n; i++) {
+            if (compareSignatures(&order[i - 1], &order[i]) != 0) k++;
+            next[order[i]] = k;
+        }
+        memcpy(color, next, n * sizeof(int));
+        if (k + 1 == cells) break;
+        cells = k + 1;
+    }
+
+    free(order);
+    free(next);
+    free(symSig);
+    free(symSigStart);
+    free(symSigLen);
+    return cells;
+}
+
+// Gives vertex v a cell of its own (just before the rest of its cell) and refines
+int individualize(SymGraph *g, int *color, int v) {
+    for (int u = 0; u < g->n; u++) color[u] = 2 * color[u] + (u != v);
+    return refine(g, color);
+}
+
+// Returns the smallest cell with more than one vertex, or -1 if the coloring is discrete
+int targetCell(int *color, int n, int cells) {
+    if (cells == n) return -1;
+    int *size = calloc(n, sizeof(int));
+    for (int v = 0; v < n; v++) size[color[v]]++;
+    int cell = 0;
+    while (size[cell] < 2) cell++;
+    free(size);
+    return cell;
+}
+
+// Compares the cell sizes of two colorings, an invariant that must match for the subtrees to be isomorphic
+int sameShape(int *color1, int *color2, int n) {
+    int *size = calloc(n, sizeof(int));
+    for (int v = 0; v < n; v++) {
+        size[color1[v]]++;
+        size[color2[v]]--;
+    }
+    int same = 1;
+    for (int c = 0; c < n && same; c++) same = size[c] == 0;
+    free(size);
+    return same;
+}
+
+// Builds the permutation mapping the first path's leaf onto another discrete coloring
+// and checks that it preserves every edge
+int leafAutomorphism(SymGraph *g, int *leaf, int *color, int *perm) {
+    int n = g->n;
+    int *vertexOf = malloc(n * sizeof(int));
+    for (int v = 0; v < n; v++) vertexOf[color[v]] = v;
+    for (int v = 0; v < n; v++) perm[v] = vertexOf[leaf[v]];
+    free(vertexOf);
+
+    for (int v = 0; v < n; v++) {
+        if (g->initial[v] != g->initial[perm[v]]) return 0;
+        for (int e = g->adjStart[v]; e < g->adjStart[v + 1]; e++) {
+            if (!g->matrix[perm[v] * n + perm[g->adj[e]]]) return 0;
+        }
+    }
+    return 1;
+}
+
+// Searches the subtree below an already refined coloring at the given level for a leaf that is
+// an automorphic image of the first leaf; subtrees whose shape differs from the first path are cut
+int symSearch(SymGraph *g, SymPath *path, int *color, int cells, int level, int *perm, int *nodes) {
+    if (++(*nodes) > SYM_NODE_LIMIT) return 0;
+    if (cells != path->cells[level] || !sameShape(color, path->colors[level], g->n)) return 0;
+    if (level == path->length) return leafAutomorphism(g, path->colors[path->length], color, perm);
+
+    int *child = malloc(g->n * sizeof(int));
+    int found = 0;
+    for (int u = 0; u < g->n && !found; u++) {
+        if (color[u] != path->target[level]) continue;
+        memcpy(child, color, g->n * sizeof(int));
+        int childCells = individualize(g, child, u);
+        found = symSearch(g, path, child, childCells, level + 1, perm, nodes);
+    }
+    free(child);
+    return found;
+}
+
+// Union-find over vertices, tracking the orbits of the generators found so far
+int orbitFind(int *parent, int v) {
+    while (parent[v] != v) v = parent[v] = parent[parent[v]];
+    return v;
+}
+
+// Builds the colored graph of a clause list (clauses assumed distinct)
+void buildSymGraph(SymGraph *g, int C, char **clauses) {
+    int litNode[52];
+    int used = 0;
+    for (int i = 0; i < C; i++) used |= clauseMask(clauses[i]);
+
+    g->numLitNodes = 0;
+    for (int v = 0; v < 26; v++) {
+        litNode[v] = litNode[26 + v] = -1;
+        if (!(used & (1 << v))) continue;
+        litNode[v] = g->numLitNodes;
+        g->nodeLit[g->numLitNodes++] = 'a' + v;
+        litNode[26 + v] = g->numLitNodes;
+        g->nodeLit[g->numLitNodes++] = 'A' + v;
+    }
+    int n = g->n = g->numLitNodes + C;
+
+    g->matrix = calloc((size_t)n * n, 1);
+    g->initial = malloc(n * sizeof(int));
+    for (int v = 0; v < n; v++) g->initial[v] = v < g->numLitNodes ? 0 : 1;
+    for (int v = 0; v < g->numLitNodes; v += 2) {
+        g->matrix[v * n + v + 1] = g->matrix[(v + 1) * n + v] = 1; // x -- X
+    }
+    for (int i = 0; i < C; i++) {
+        int c = g->numLitNodes + i;
+        for (int j = 0; clauses[i][j] != '\0'; j++) {
+            int l = litNode[litIndex(clauses[i][j])];
+            g->matrix[c * n + l] = g->matrix[l * n + c] = 1;
+        }
+    }
+
+    // Adjacency lists from the matrix
+    g->adjStart = malloc((n + 1) * sizeof(int));
+    int edges = 0;
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) edges += g->matrix[u * n + v];
+    }
+    g->adj = malloc((edges > 0 ? edges : 1) * sizeof(int));
+    int pos = 0;
+    for (int u = 0; u < n; u++) {
+        g->adjStart[u] = pos;
+        for (int v = 0; v < n; v++) {
+            if (g->matrix[u * n + v]) g->adj[pos++] = v;
+        }
+    }
+    g->adjStart[n] = pos;
+}
+
+void freeSymGraph(SymGraph *g) {
+    free(g->matrix);
+    free(g->initial);
+    free(g->adjStart);
+    free(g->adj);
+}
+
+// Finds generators of the formula's symmetry group
+// Each generator is written as a literal map: generators[k][litIndex(lit)] is the image of lit
+// Returns the number of generators (possibly not a full generating set if the search hits its limits)
+int findSymmetries(int C, char **clauses, char generators[][52]) {
+    SymGraph g;
+    buildSymGraph(&g, C, clauses);
+    int n = g.n;
+
+    // First path: always individualize the smallest vertex of the smallest non-singleton cell
+    SymPath path;
+    path.colors = malloc((n + 1) * sizeof(int *));
+    path.cells = malloc((n + 1) * sizeof(int));
+    path.target = malloc((n + 1) * sizeof(int));
+    path.chosen = malloc((n + 1) * sizeof(int));
+    path.colors[0] = malloc(n * sizeof(int));
+    memcpy(path.colors[0], g.initial, n * sizeof(int));
+    path.cells[0] = refine(&g, path.colors[0]);
+    path.length = 0;
+    while (1) {
+        int level = path.length;
+        int cell = targetCell(path.colors[level], n, path.cells[level]);
+        if (cell == -1) break;
+        int v = 0;
+        while (path.colors[level][v] != cell) v++;
+        path.target[level] = cell;
+        path.chosen[level] = v;
+        path.colors[level + 1] = malloc(n * sizeof(int));
+        memcpy(path.colors[level + 1], path.colors[level], n * sizeof(int));
+        path.cells[level + 1] = individualize(&g, path.colors[level + 1], v);
+        path.length++;
+    }
+
+    int *orbit = malloc(n * sizeof(int));
+    for (int v = 0; v < n; v++) orbit[v] = v;
+    int *perm = malloc(n * sizeof(int));
+    int *color = malloc(n * sizeof(int));
+    int count = 0;
+
+    // From the deepest level up, try to map the chosen vertex onto the others of its cell
+    // All generators found so far fix the vertices chosen above the current level, so
+    // vertices already in the chosen vertex's orbit can be skipped
+    for (int level = path.length - 1; level >= 0 && count < SYM_MAX_GENERATORS; level--) {
+        int v = path.chosen[level];
+        for (int w = 0; w < n && count < SYM_MAX_GENERATORS; w++) {
+            if (w == v || path.colors[level][w] != path.target[level]) continue;
+            if (orbitFind(orbit, w) == orbitFind(orbit, v)) continue;
+
+            memcpy(color, path.colors[level], n * sizeof(int));
+            int cells = individualize(&g, color, w);
+            int nodes = 0;
+            if (!symSearch(&g, &path, color, cells, level + 1, perm, &nodes)) continue;
+
+            for (int u = 0; u < n; u++) {
+                orbit[orbitFind(orbit, u)] = orbitFind(orbit, perm[u]);
+            }
+            for (int l = 0; l < 52; l++) generators[count][l] = indexLit(l);
+            for (int u = 0; u < g.numLitNodes; u++) {
+                generators[count][litIndex(g.nodeLit[u])] = g.nodeLit[perm[u]];
+            }
+            count++;
+        }
+    }
+
+    for (int level = 0; level <= path.length; level++) free(path.colors[level]);
+    free(path.colors);
+    free(path.cells);
+    free(path.target);
+    free(path.chosen);
+    free(orbit);
+    free(perm);
+    free(color);
+    freeSymGraph(&g);
+    return count;
+}
+
+// Appends the lex-leader clauses of one generator, for the variable order a < b < ... and false < true
+// Position i says: if x1 = s(x1), ..., x(i-1) = s(x(i-1)) then x(i) <= s(x(i)), i.e. the clause (X(i) v s(x(i)))
+// plus, for every earlier position j, one of (x(j) v s(x(j))) or (X(j) v S(x(j))) expressing x(j) != s(x(j))
+// Only the first SBP_DEPTH moved variables are encoded, which keeps the clauses few and is still sound
+int addLexLeader(char *sigma, char ***out, int *total, int *capacity) {
+    char prefix[SBP_DEPTH][2];
+    int depth = 0, added = 0;
+
+    for (int v = 0; v < 26 && depth < SBP_DEPTH; v++) {
+        char x = 'a' + v, y = sigma[litIndex(x)];
+        if (y == x) continue; // Fixed variable, equal on both sides
+
+        for (int mask = 0; mask < (1 << depth); mask++) {
+            char clause[2 + 2 * SBP_DEPTH + 1];
+            int k = 0;
+            clause[k++] = negate(x);
+            clause[k++] = y;
+            for (int j = 0; j < depth; j++) {
+                int flip = (mask >> j) & 1;
+                clause[k++] = flip ? negate(prefix[j][0]) : prefix[j][0];
+                clause[k++] = flip ? negate(prefix[j][1]) : prefix[j][1];
+            }
+            clause[k] = '\0';
+
+            int tautology = 0;
+            for (int i = 0; i < k && !tautology; i++) tautology = clauseContains(clause, negate(clause[i]));
+            if (tautology) continue;
+
+            char *copy = clause;
+            char *key = canonicalKey(&copy, 1);
+            key[strlen(key) - 1] = '\0'; // Drop the trailing ','
+            if (!isNewClause(*out, *total, key)) { // Already added by another generator
+                free(key);
+                continue;
+            }
+
+            if (*total == *capacity) {
+                *capacity *= 2;
+                *out = realloc(*out, *capacity * sizeof(char *));
+            }
+            (*out)[(*total)++] = key;
+            added++;
+        }
+
+        if (y == negate(x)) break; // x = X never holds, later positions are unreachable
+        prefix[depth][0] = x;
+        prefix[depth][1] = y;
+        depth++;
+    }
+    return added;
+}
+
+// Symmetry-breaking preprocessing: returns a new clause list (the original clauses plus the
+// lex-leader clauses of every symmetry generator found) and stores its size in newC
+// The result is equisatisfiable with the input but has fewer models, so it is only used for solving
+char **breakSymmetries(int C, char **clauses, int *newC) {
+    // Distinct clauses in canonical form, so duplicates do not show up as symmetries
+    int capacity = C > 16 ? 2 * C : 32, total = 0;
+    char **out = malloc(capacity * sizeof(char *));
+    for (int i = 0; i < C; i++) {
+        char *clause = canonicalKey(&clauses[i], 1);
+        clause[strlen(clause) - 1] = '\0';
+        if (isNewClause(out, total, clause)) out[total++] = clause;
+        else free(clause);
+    }
+    int original = total;
+
+    char (*generators)[52] = malloc(SYM_MAX_GENERATORS * sizeof(*generators));
+    int numGenerators = findSymmetries(total, out, generators);
+
+    printf("Symmetry: %d generator(s) found.\n", numGenerators);
+    for (int k = 0; k < numGenerators; k++) {
+        printf("  ");
+        for (int v = 0; v < 26; v++) {
+            char image = generators[k][v];
+            if (image != 'a' + v) printf("%c->%c ", 'a' + v, image);
+        }
+        addLexLeader(generators[k], &out, &total, &capacity);
+        printf("\n");
+    }
+    printf("Added %d symmetry-breaking clause(s).\n\n", total - original);
+
+    free(generators);
+    *newC = total;
+    return out;
+}
+
 int main() {
     clearTerminal();
     printf("Welcome to SAT Resolution!\n\n");
@@ -449,14 +2173,23 @@ int main() {
                 if (clauses == NULL || C == 0) {
                     printf("No clauses to resolve. Please read clauses first.\n\n");
                 } else {
+                    // Symmetry breaking works on a copy with the extra clauses
+                    int solveC = C;
+                    char **solveClauses = clauses;
+                    if (useSymmetry) solveClauses = breakSymmetries(C, clauses, &solveC);
+
                     if (track) {
                         clock_t start = clock();
-                        resolution(C, clauses);
+                        resolution(solveC, solveClauses);
                         clock_t end = clock();
                         printf("Time taken: %.2f ms\n",
                             ((double)(end - start)) * 1000 / CLOCKS_PER_SEC);
                     } else {
-                        resolution(C, clauses);
+                        resolution(solveC, solveClauses);
+                    }
+                    if (solveClauses != clauses) {
+                        for (int i = 0; i < solveC; i++) free(solveClauses[i]);
+                        free(solveClauses);
                     }
                     printf("Press Enter to continue...\n");
                     while ((getchar()) != '\n' && getchar() != EOF);
@@ -470,14 +2203,23 @@ int main() {
                 if (clauses == NULL || C == 0) {
                     printf("No clauses to resolve. Please read clauses first.\n\n");
                 } else {
+                    // Symmetry breaking works on a copy with the extra clauses
+                    int solveC = C;
+                    char **solveClauses = clauses;
+                    if (useSymmetry) solveClauses = breakSymmetries(C, clauses, &solveC);
+
                     if (track) {
                         clock_t start = clock();
-                        dp(C, clauses, 0);
+                        dp(solveC, solveClauses, 0);
                         clock_t end = clock();
                         printf("Time taken: %.2f ms\n",
                             ((double)(end - start)) * 1000 / CLOCKS_PER_SEC);
                     } else {
-                        dp(C, clauses, 0);
+                        dp(solveC, solveClauses, 0);
+                    }
+                    if (solveClauses != clauses) {
+                        for (int i = 0; i < solveC; i++) free(solveClauses[i]);
+                        free(solveClauses);
                     }
                     printf("Press Enter to continue...\n");
                     while ((getchar()) != '\n' && getchar() != EOF);
@@ -491,14 +2233,23 @@ int main() {
                 if (clauses == NULL || C == 0) {
                     printf("No clauses to resolve. Please read clauses first.\n\n");
                 } else {
+                    // Symmetry breaking works on a copy with the extra clauses
+                    int solveC = C;
+                    char **solveClauses = clauses;
+                    if (useSymmetry) solveClauses = breakSymmetries(C, clauses, &solveC);
+
                     if (track) {
                         clock_t start = clock();
-                        dp(C, clauses, 1);
+                        dp(solveC, solveClauses, 1);
                         clock_t end = clock();
                         printf("Time taken: %.2f ms\n",
                             ((double)(end - start)) * 1000 / CLOCKS_PER_SEC);
                     } else {
-                        dp(C, clauses, 1);
+                        dp(solveC, solveClauses, 1);
+                    }
+                    if (solveClauses != clauses) {
+                        for (int i = 0; i < solveC; i++) free(solveClauses[i]);
+                        free(solveClauses);
                     }
                     printf("Press Enter to continue...\n");
                     while ((getchar()) != '\n' && getchar() != EOF);
@@ -522,6 +2273,9 @@ int main() {
                     }
                     free(clauses);
                 }
+                clearComponentCache();
+                clearCheckpoint();
+                closeResultCache();
 
                 printf("Press Enter to exit...\n");
                 while ((getchar()) != '\n' && getchar() != EOF);
@@ -529,6 +2283,102 @@ int main() {
                 clearTerminal();
                 return 0;
 
+            case 8: // Model enumeration
+                clearTerminal();
+                if (clauses == NULL || C == 0) {
+                    printf("No clauses to resolve. Please read clauses first.\n\n");
+                } else {
+                    if (track) {
+                        clock_t start = clock();
+                        enumerateModels(C, clauses);
+                        clock_t end = clock();
+                        printf("Time taken: %.2f ms\n",
+                            ((double)(end - start)) * 1000 / CLOCKS_PER_SEC);
+                    } else {
+                        enumerateModels(C, clauses);
+                    }
+                    printf("Press Enter to continue...\n");
+                    while ((getchar()) != '\n' && getchar() != EOF);
+                    getchar();
+                    clearTerminal();
+                }
+                break;
+
+            case 9: // Model counting
+                clearTerminal();
+                if (clauses == NULL || C == 0) {
+                    printf("No clauses to resolve. Please read clauses first.\n\n");
+                } else {
+                    if (track) {
+                        clock_t start = clock();
+                        countModels(C, clauses);
+                        clock_t end = clock();
+                        printf("Time taken: %.2f ms\n",
+                            ((double)(end - start)) * 1000 / CLOCKS_PER_SEC);
+                    } else {
+                        countModels(C, clauses);
+                    }
+                    printf("Press Enter to continue...\n");
+                    while ((getchar()) != '\n' && getchar() != EOF);
+                    getchar();
+                    clearTerminal();
+                }
+                break;
+
+            case 10: // Cycle result cache mode: off -> on -> on with renaming
+                useCache = (useCache + 1) % 3;
+                clearTerminal();
+                break;
+
+            case 11: // Parallel resolution
+                clearTerminal();
+                if (clauses == NULL || C == 0) {
+                    printf("No clauses to resolve. Please read clauses first.\n\n");
+                } else {
+                    int numThreads;
+                    printf("Enter the number of threads: ");
+                    if (scanf("%d", &numThreads) != 1 || numThreads <= 0) numThreads = 1;
+                    while ((getchar()) != '\n'); // Clear newline
+                    if (numThreads > MAX_THREADS) {
+                        printf("Using the maximum of %d threads.\n", MAX_THREADS);
+                        numThreads = MAX_THREADS;
+                    }
+
+                    // Symmetry breaking works on a copy with the extra clauses
+                    int solveC = C;
+                    char **solveClauses = clauses;
+                    if (useSymmetry) solveClauses = breakSymmetries(C, clauses, &solveC);
+
+                    if (track) {
+                        clock_t start = clock();
+                        parallelResolution(solveC, solveClauses, numThreads);
+                        clock_t end = clock();
+                        printf("Time taken: %.2f ms\n",
+                            ((double)(end - start)) * 1000 / CLOCKS_PER_SEC);
+                    } else {
+                        parallelResolution(solveC, solveClauses, numThreads);
+                    }
+                    if (solveClauses != clauses) {
+                        for (int i = 0; i < solveC; i++) free(solveClauses[i]);
+                        free(solveClauses);
+                    }
+                    printf("Press Enter to continue...\n");
+                    while ((getchar()) != '\n' && getchar() != EOF);
+                    getchar();
+                    clearTerminal();
+                }
+                break;
+
+            case 12: // Budgets
+                clearTerminal();
+                readBudget();
+                break;
+
+            case 13: // Toggle symmetry breaking
+                useSymmetry = !useSymmetry;
+                clearTerminal();
+                break;
+
             default:
                 printf("Invalid choice. Try again.\n\n");
                 break;